@@ -16,9 +16,16 @@
 #include "Landscape.h"
 #include "LandscapeInfo.h"
 #include "LandscapeDataAccess.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Input/SButton.h"
+#include "VisionMeshCodec.h"
 
 static const FName VisionExporterTabName("VisionExporter");
 
+DEFINE_LOG_CATEGORY_STATIC(LogVisionExporter, Log, All);
+
 #define LOCTEXT_NAMESPACE "FVisionExporterModule"
 
 extern ENGINE_API class UWorldProxy GWorld;
@@ -61,6 +68,11 @@ public:
 	/** Name used when writing this object to the OBJ file. */
 	FString Name;
 
+	/** Quantization grid shared with neighbouring objects, in written out axis order, so compressed seams line up. */
+	bool bSharedGrid = false;
+	float GridOrigin[3];
+	float GridStep[3];
+
 	// Constructors.
 	OBJGeom(const FString& InName)
 		: Name(InName)
@@ -138,6 +150,103 @@ void OutputObjMesh(OBJGeom *object, FString TargetPath) {
 	return;
 }
 
+// Writes the same geometry as OutputObjMesh through VisionMeshCodec, keeping its axis and uv conventions.
+void OutputVisionMesh(const OBJGeom *object, FString Filename) {
+	const int32 VertexCount = object->VertexData.Num();
+
+	TArray<float> Positions, Normals, UVs;
+	Positions.SetNumUninitialized(VertexCount * 3);
+	Normals.SetNumUninitialized(VertexCount * 3);
+	UVs.SetNumUninitialized(VertexCount * 2);
+	for (int32 f = 0; f < VertexCount; ++f)
+	{
+		const OBJVertex& vertex = object->VertexData[f];
+
+		Positions[f * 3 + 0] = (float)vertex.Vert.X;
+		Positions[f * 3 + 1] = (float)vertex.Vert.Z;
+		Positions[f * 3 + 2] = (float)vertex.Vert.Y;
+
+		Normals[f * 3 + 0] = (float)vertex.Normal.X;
+		Normals[f * 3 + 1] = (float)vertex.Normal.Z;
+		Normals[f * 3 + 2] = (float)vertex.Normal.Y;
+
+		UVs[f * 2 + 0] = (float)vertex.UV.X;
+		UVs[f * 2 + 1] = 1.0f - (float)vertex.UV.Y;
+	}
+
+	TArray<uint32> Indices;
+	Indices.Reserve(object->Faces.Num() * 3);
+	for (const OBJFace& face : object->Faces)
+	{
+		Indices.Append(face.VertexIndex, 3);
+	}
+
+	FTCHARToUTF8 Name(*object->Name);
+
+	VisionMeshCodec::FMeshView View;
+	if (object->bSharedGrid)
+	{
+		View.GridOrigin = object->GridOrigin;
+		View.GridStep = object->GridStep;
+	}
+	View.Name = Name.Get();
+	View.NameLength = Name.Length();
+	View.Positions = Positions.GetData();
+	View.Normals = Normals.GetData();
+	View.UVs = UVs.GetData();
+	View.VertexCount = VertexCount;
+	View.Indices = Indices.GetData();
+	View.IndexCount = Indices.Num();
+
+	std::vector<uint8_t> Encoded = VisionMeshCodec::EncodeMesh(View);
+	if (!FFileHelper::SaveArrayToFile(TArrayView64<const uint8>(Encoded.data(), Encoded.size()), *Filename))
+	{
+		UE_LOG(LogVisionExporter, Error, TEXT("Failed to write %s"), *Filename);
+	}
+}
+
+// Gives adjacent geometries, like the components of one landscape, a common quantization grid
+// so their shared border vertices decode to identical positions.
+void ShareQuantizationGrid(TArrayView<TSharedPtr<OBJGeom>> objects) {
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		// same axis order as OutputVisionMesh writes
+		const int32 Component = Axis == 0 ? 0 : (Axis == 1 ? 2 : 1);
+
+		float Min = MAX_flt, Max = -MAX_flt, Extent = 0.0f;
+		for (const TSharedPtr<OBJGeom>& object : objects)
+		{
+			float ObjectMin = MAX_flt, ObjectMax = -MAX_flt;
+			for (const OBJVertex& vertex : object->VertexData)
+			{
+				const float Value = (float)vertex.Vert[Component];
+				ObjectMin = FMath::Min(ObjectMin, Value);
+				ObjectMax = FMath::Max(ObjectMax, Value);
+			}
+			if (ObjectMin <= ObjectMax)
+			{
+				Min = FMath::Min(Min, ObjectMin);
+				Max = FMath::Max(Max, ObjectMax);
+				Extent = FMath::Max(Extent, ObjectMax - ObjectMin);
+			}
+		}
+		if (Min > Max)
+		{
+			return;
+		}
+
+		// one cell of slack for where each object's range starts on the grid, and keep
+		// the cell index of every vertex within int32 even when all objects are flat
+		const float Step = FMath::Max(Extent / 65534.0f, (Max - Min) / (float)(1 << 30));
+		for (const TSharedPtr<OBJGeom>& object : objects)
+		{
+			object->bSharedGrid = true;
+			object->GridOrigin[Axis] = Min;
+			object->GridStep[Axis] = Step;
+		}
+	}
+}
+
 
 UWorld *FVisionExporterModule::GetWorld() const noexcept {
 	return GWorld.GetReference();
@@ -163,6 +272,7 @@ TArray<TSharedPtr<OBJGeom>> FVisionExporterModule::ActorToObjs(AActor* Actor, bo
 	ALandscape* Landscape = Cast<ALandscape>(Actor);
 	ULandscapeInfo* LandscapeInfo = Landscape ? Landscape->GetLandscapeInfo() : NULL;
 	if (Landscape && LandscapeInfo) {
+		const int32 FirstComponentObject = Objects.Num();
 		auto SelectedComponents = LandscapeInfo->GetSelectedComponents();
 		// Export data for each component
 		for (auto It = Landscape->GetLandscapeInfo()->XYtoComponentMap.CreateIterator(); It; ++It)
@@ -250,6 +360,8 @@ TArray<TSharedPtr<OBJGeom>> FVisionExporterModule::ActorToObjs(AActor* Actor, bo
 
 			Objects.Add(objGeom);
 		}
+
+		ShareQuantizationGrid(TArrayView<TSharedPtr<OBJGeom>>(Objects.GetData() + FirstComponentObject, Objects.Num() - FirstComponentObject));
 	}
 
 	// Static mesh components
@@ -383,7 +495,15 @@ TArray<AActor*> FVisionExporterModule::GetActors(bool bSelectedOnly) const noexc
 
 
 void FVisionExporterModule::ExportMeshes(UAssetExportTask* ExportTask) const noexcept {
-	ExportMeshesToObj(ExportTask);
+	switch (GeometryEncoding)
+	{
+	case EGeometryEncoding::Compressed:
+		ExportMeshesCompressed(ExportTask);
+		break;
+	default:
+		ExportMeshesToObj(ExportTask);
+		break;
+	}
 }
 
 void FVisionExporterModule::ExportMeshesToObj(UAssetExportTask* ExportTask) const noexcept {
@@ -397,30 +517,81 @@ void FVisionExporterModule::ExportMeshesToObj(UAssetExportTask* ExportTask) cons
 	}
 }
 
+void FVisionExporterModule::ExportMeshesCompressed(UAssetExportTask* ExportTask) const noexcept {
+	FString TargetPath = FEditorDirectories::Get().GetLastDirectory(ELastDirectory::UNR);
+
+	TArray<TSharedPtr<OBJGeom>> objGeoms = GetOBJGeoms(ExportTask->bSelected);
+
+	// objects can share a name, so pick a distinct file for each before writing them concurrently
+	TArray<FString> Filenames;
+	TSet<FString> UsedNames;
+	for (const TSharedPtr<OBJGeom>& object : objGeoms)
+	{
+		FString Name = object->Name;
+		for (int32 Suffix = 1; UsedNames.Contains(Name); ++Suffix)
+		{
+			Name = FString::Printf(TEXT("%s_%d"), *object->Name, Suffix);
+		}
+		UsedNames.Add(Name);
+		Filenames.Add(TargetPath + TEXT("/") + Name + TEXT(".vmesh"));
+	}
+
+	// meshes are independent, encode and write them on the task graph
+	ParallelFor(objGeoms.Num(), [&objGeoms, &Filenames](int32 i)
+	{
+		OutputVisionMesh(objGeoms[i].Get(), Filenames[i]);
+	});
+}
+
 void FVisionExporterModule::ExportMeshesToGLTF(UAssetExportTask* ExportTask) const noexcept {
 
 }
 
 TSharedRef<SDockTab> FVisionExporterModule::OnSpawnPluginTab(const FSpawnTabArgs& SpawnTabArgs)
 {
-
-	UAssetExportTask* ExportTask = InitExportTask("Test.obj", false);
-	FGCObjectScopeGuard ExportTaskGuard(ExportTask);
-
-	//ExportMeshes(ExportTask);
-
 	auto checkBox = SNew(SCheckBox).Style(FCoreStyle::Get(), "RadioButton")
 		[
 			SNew(STextBlock)
 			.Text(LOCTEXT("", "export to vision"))
 		];
 
+	auto compressCheckBox = SNew(SCheckBox)
+		.IsChecked_Lambda([this]() { return GeometryEncoding == EGeometryEncoding::Compressed ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+		.OnCheckStateChanged_Lambda([this](ECheckBoxState State) { GeometryEncoding = State == ECheckBoxState::Checked ? EGeometryEncoding::Compressed : EGeometryEncoding::Text; })
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("CompressGeometry", "compress geometry"))
+		];
+
+	auto exportButton = SNew(SButton)
+		.Text(LOCTEXT("Export", "export"))
+		.OnClicked_Lambda([this]()
+		{
+			UAssetExportTask* ExportTask = InitExportTask("Test.obj", false);
+			FGCObjectScopeGuard ExportTaskGuard(ExportTask);
+
+			ExportMeshes(ExportTask);
+			return FReply::Handled();
+		});
+
 	return SNew(SDockTab)
 		.TabRole(ETabRole::PanelTab).Label(LOCTEXT("", "vision exporter"))
 		[
 			SNew(SBox).HAlign(HAlign_Left).VAlign(VAlign_Top)
 			[
-				checkBox
+				SNew(SVerticalBox)
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					checkBox
+				]
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					compressCheckBox
+				]
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					exportButton
+				]
 			]
 		];
 }
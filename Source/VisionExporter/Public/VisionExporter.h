@@ -11,6 +11,15 @@ class FMenuBuilder;
 class UAssetExportTask;
 class OBJGeom;
 
+/** How geometry payloads are written out. */
+enum class EGeometryEncoding : uint8
+{
+	/** Full precision Wavefront OBJ text. */
+	Text,
+	/** Quantized attributes in compressed streams, see VisionMeshCodec.h. */
+	Compressed,
+};
+
 class FVisionExporterModule : public IModuleInterface
 {
 public:
@@ -31,6 +40,7 @@ private:
 	[[nodiscard]] TArray<TSharedPtr<OBJGeom>> ActorToObjs(AActor* Actor, bool bSelectedOnly) const noexcept;
 	void ExportMeshes(UAssetExportTask*) const noexcept;
 	void ExportMeshesToObj(UAssetExportTask*) const noexcept;
+	void ExportMeshesCompressed(UAssetExportTask*) const noexcept;
 	void ExportMeshesToGLTF(UAssetExportTask*) const noexcept;
 
 	[[nodiscard]] UAssetExportTask* InitExportTask(FString Filename, bool bSelected) const noexcept;
@@ -40,4 +50,6 @@ private:
 private:
 	TSharedPtr<class FUICommandList> PluginCommands;
 
+	EGeometryEncoding GeometryEncoding = EGeometryEncoding::Text;
+
 };
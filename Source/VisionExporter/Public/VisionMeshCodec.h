@@ -0,0 +1,784 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Compact binary geometry encoding shared by the exporter and the standalone decoder.
+// Only depends on the standard library so render nodes can decode without the engine.
+//
+// File layout (little endian):
+//   header  : magic "VMSH", version, vertex count, index count, grid origin, grid step, grid offset,
+//             uv offset, name
+//   streams : indices, positions, normals, uvs, each as raw size, packed size, payload
+//
+// Indices are delta + zigzag varint coded. Positions are quantized to 16 bit cells of a grid,
+// decoded as origin + (offset + cell) * step. By default the grid spans the mesh bounds;
+// meshes that must line up exactly, like landscape components, can pass one shared grid so
+// their common border vertices decode to bit identical positions. Normals are stored
+// octahedrally as two snorm16 and uvs as half floats relative to the floored uv minimum,
+// so absolute landscape uvs keep their precision.
+// Every vertex channel is delta + zigzag coded and split into byte planes, then each stream
+// is packed with a small LZ77 block codec; a stream that does not shrink is stored raw.
+namespace VisionMeshCodec
+{
+	constexpr uint32_t Magic = 0x48534D56;
+	constexpr uint32_t Version = 3;
+
+	/** Geometry to encode. Attribute arrays are tightly packed floats, one entry per vertex. */
+	struct FMeshView
+	{
+		const char* Name = nullptr;
+		size_t NameLength = 0;
+
+		const float* Positions = nullptr; // xyz
+		const float* Normals = nullptr;   // xyz
+		const float* UVs = nullptr;       // uv
+		size_t VertexCount = 0;
+
+		const uint32_t* Indices = nullptr;
+		size_t IndexCount = 0;
+
+		/**
+		 * Optional quantization grid shared with other meshes, xyz origin and step. The step must
+		 * leave this mesh's extent within 65534 cells. When null the grid spans this mesh's bounds.
+		 */
+		const float* GridOrigin = nullptr;
+		const float* GridStep = nullptr;
+	};
+
+	struct FDecodedMesh
+	{
+		std::string Name;
+		float GridOrigin[3] = {};
+		float GridStep[3] = {};
+		int32_t GridOffset[3] = {};
+		float UVOffset[2] = {};
+
+		std::vector<float> Positions;
+		std::vector<float> Normals;
+		std::vector<float> UVs;
+		std::vector<uint32_t> Indices;
+	};
+
+	namespace Detail
+	{
+		constexpr size_t LzMinMatch = 4;
+		constexpr size_t LzMaxOffset = 65535;
+		constexpr size_t LzLastLiterals = 5;
+		constexpr size_t LzMatchSearchLimit = 12;
+		constexpr uint32_t LzHashBits = 14;
+
+		inline uint32_t Read32(const uint8_t* Ptr)
+		{
+			uint32_t Value;
+			memcpy(&Value, Ptr, sizeof(Value));
+			return Value;
+		}
+
+		inline uint32_t LzHash(uint32_t Sequence)
+		{
+			return (Sequence * 2654435761u) >> (32 - LzHashBits);
+		}
+
+		inline void LzWriteLength(std::vector<uint8_t>& Out, size_t Length)
+		{
+			while (Length >= 255)
+			{
+				Out.push_back(255);
+				Length -= 255;
+			}
+			Out.push_back(uint8_t(Length));
+		}
+
+		inline bool LzReadLength(const uint8_t*& Ip, const uint8_t* IEnd, size_t& Length)
+		{
+			uint8_t Byte;
+			do
+			{
+				if (Ip >= IEnd)
+				{
+					return false;
+				}
+				Byte = *Ip++;
+				Length += Byte;
+			} while (Byte == 255);
+			return true;
+		}
+
+		inline void LzEmitLiterals(std::vector<uint8_t>& Out, uint8_t Token, const uint8_t* Literals, size_t Count)
+		{
+			Out.push_back(uint8_t(Token | ((Count < 15 ? Count : 15) << 4)));
+			if (Count >= 15)
+			{
+				LzWriteLength(Out, Count - 15);
+			}
+			Out.insert(Out.end(), Literals, Literals + Count);
+		}
+
+		/** LZ4 style block compression: greedy hash matching, 64KB window. */
+		inline std::vector<uint8_t> LzCompress(const uint8_t* Src, size_t Size)
+		{
+			std::vector<uint8_t> Out;
+			Out.reserve(Size + Size / 255 + 16);
+
+			size_t Anchor = 0;
+			if (Size > LzMatchSearchLimit)
+			{
+				// positions are stored +1 so that zero marks an empty slot
+				std::vector<uint32_t> Table(size_t(1) << LzHashBits, 0);
+				const size_t SearchEnd = Size - LzMatchSearchLimit;
+				const size_t MatchEnd = Size - LzLastLiterals;
+				size_t Pos = 0;
+				size_t Misses = 0;
+
+				while (Pos < SearchEnd)
+				{
+					const uint32_t Sequence = Read32(Src + Pos);
+					uint32_t& Slot = Table[LzHash(Sequence)];
+					size_t Candidate = Slot;
+					Slot = uint32_t(Pos + 1);
+
+					if (Candidate == 0 || Pos - (Candidate - 1) > LzMaxOffset || Read32(Src + Candidate - 1) != Sequence)
+					{
+						// step faster through data that does not compress
+						Pos += 1 + (Misses++ >> 6);
+						continue;
+					}
+					Candidate -= 1;
+					Misses = 0;
+
+					while (Pos > Anchor && Candidate > 0 && Src[Pos - 1] == Src[Candidate - 1])
+					{
+						--Pos;
+						--Candidate;
+					}
+
+					size_t MatchLength = LzMinMatch;
+					while (Pos + MatchLength < MatchEnd && Src[Pos + MatchLength] == Src[Candidate + MatchLength])
+					{
+						++MatchLength;
+					}
+
+					const size_t ExtraLength = MatchLength - LzMinMatch;
+					const size_t Offset = Pos - Candidate;
+					LzEmitLiterals(Out, uint8_t(ExtraLength < 15 ? ExtraLength : 15), Src + Anchor, Pos - Anchor);
+					Out.push_back(uint8_t(Offset & 0xFF));
+					Out.push_back(uint8_t(Offset >> 8));
+					if (ExtraLength >= 15)
+					{
+						LzWriteLength(Out, ExtraLength - 15);
+					}
+
+					Pos += MatchLength;
+					Anchor = Pos;
+					if (Pos - 2 < SearchEnd)
+					{
+						Table[LzHash(Read32(Src + Pos - 2))] = uint32_t(Pos - 2 + 1);
+					}
+				}
+			}
+
+			// the last sequence only carries literals
+			LzEmitLiterals(Out, 0, Src + Anchor, Size - Anchor);
+			return Out;
+		}
+
+		/** Decodes a block produced by LzCompress. Fails unless exactly DstSize bytes come out. */
+		inline bool LzDecompress(const uint8_t* Src, size_t SrcSize, uint8_t* Dst, size_t DstSize)
+		{
+			const uint8_t* Ip = Src;
+			const uint8_t* const IEnd = Src + SrcSize;
+			uint8_t* Op = Dst;
+			uint8_t* const OEnd = Dst + DstSize;
+
+			while (Ip < IEnd)
+			{
+				const uint8_t Token = *Ip++;
+
+				size_t LiteralLength = Token >> 4;
+				if (LiteralLength == 15 && !LzReadLength(Ip, IEnd, LiteralLength))
+				{
+					return false;
+				}
+				if (LiteralLength > size_t(IEnd - Ip) || LiteralLength > size_t(OEnd - Op))
+				{
+					return false;
+				}
+				memcpy(Op, Ip, LiteralLength);
+				Op += LiteralLength;
+				Ip += LiteralLength;
+
+				if (Ip == IEnd)
+				{
+					break;
+				}
+
+				if (IEnd - Ip < 2)
+				{
+					return false;
+				}
+				const size_t Offset = size_t(Ip[0]) | (size_t(Ip[1]) << 8);
+				Ip += 2;
+				if (Offset == 0 || Offset > size_t(Op - Dst))
+				{
+					return false;
+				}
+
+				size_t MatchLength = Token & 15;
+				if (MatchLength == 15 && !LzReadLength(Ip, IEnd, MatchLength))
+				{
+					return false;
+				}
+				MatchLength += LzMinMatch;
+				if (MatchLength > size_t(OEnd - Op))
+				{
+					return false;
+				}
+
+				const uint8_t* Match = Op - Offset;
+				if (Offset >= MatchLength)
+				{
+					memcpy(Op, Match, MatchLength);
+					Op += MatchLength;
+				}
+				else
+				{
+					// overlapping match repeats the last Offset bytes
+					for (size_t i = 0; i < MatchLength; ++i)
+					{
+						*Op++ = *Match++;
+					}
+				}
+			}
+
+			return Op == OEnd;
+		}
+
+		inline uint16_t ZigZag16(uint16_t Delta)
+		{
+			return uint16_t((Delta << 1) ^ uint16_t(int16_t(Delta) >> 15));
+		}
+
+		inline uint16_t UnZigZag16(uint16_t Value)
+		{
+			return uint16_t((Value >> 1) ^ uint16_t(0 - (Value & 1)));
+		}
+
+		inline uint32_t ZigZag32(uint32_t Delta)
+		{
+			return (Delta << 1) ^ uint32_t(int32_t(Delta) >> 31);
+		}
+
+		inline uint32_t UnZigZag32(uint32_t Value)
+		{
+			return (Value >> 1) ^ (0u - (Value & 1));
+		}
+
+		/**
+		 * Delta codes each channel of an interleaved uint16 array against the previous vertex
+		 * and writes it out as a plane of low bytes followed by a plane of high bytes.
+		 */
+		inline std::vector<uint8_t> PackChannels(const std::vector<uint16_t>& Values, size_t Channels)
+		{
+			const size_t Count = Values.size() / Channels;
+			std::vector<uint8_t> Out(Values.size() * 2);
+			for (size_t c = 0; c < Channels; ++c)
+			{
+				uint8_t* Low = Out.data() + c * Count * 2;
+				uint8_t* High = Low + Count;
+				uint16_t Previous = 0;
+				for (size_t i = 0; i < Count; ++i)
+				{
+					const uint16_t Value = Values[i * Channels + c];
+					const uint16_t Coded = ZigZag16(uint16_t(Value - Previous));
+					Previous = Value;
+					Low[i] = uint8_t(Coded & 0xFF);
+					High[i] = uint8_t(Coded >> 8);
+				}
+			}
+			return Out;
+		}
+
+		inline void UnpackChannels(const std::vector<uint8_t>& Packed, size_t Channels, std::vector<uint16_t>& OutValues)
+		{
+			const size_t Count = Packed.size() / (Channels * 2);
+			OutValues.resize(Count * Channels);
+			for (size_t c = 0; c < Channels; ++c)
+			{
+				const uint8_t* Low = Packed.data() + c * Count * 2;
+				const uint8_t* High = Low + Count;
+				uint16_t Previous = 0;
+				for (size_t i = 0; i < Count; ++i)
+				{
+					Previous = uint16_t(Previous + UnZigZag16(uint16_t(Low[i] | (High[i] << 8))));
+					OutValues[i * Channels + c] = Previous;
+				}
+			}
+		}
+
+		inline uint16_t FloatToHalf(float Value)
+		{
+			uint32_t Bits;
+			memcpy(&Bits, &Value, sizeof(Bits));
+
+			const uint32_t Sign = (Bits >> 16) & 0x8000;
+			const uint32_t RawExponent = (Bits >> 23) & 0xFF;
+			uint32_t Mantissa = Bits & 0x7FFFFF;
+
+			if (RawExponent == 0xFF)
+			{
+				return uint16_t(Sign | 0x7C00 | (Mantissa ? 0x200 : 0));
+			}
+
+			const int32_t Exponent = int32_t(RawExponent) - 127 + 15;
+			if (Exponent >= 31)
+			{
+				return uint16_t(Sign | 0x7C00);
+			}
+			if (Exponent <= 0)
+			{
+				if (Exponent < -10)
+				{
+					return uint16_t(Sign);
+				}
+				// denormal, round to nearest even
+				Mantissa |= 0x800000;
+				const uint32_t Shift = uint32_t(14 - Exponent);
+				uint32_t Half = Mantissa >> Shift;
+				const uint32_t Remainder = Mantissa & ((1u << Shift) - 1);
+				const uint32_t Midpoint = 1u << (Shift - 1);
+				if (Remainder > Midpoint || (Remainder == Midpoint && (Half & 1)))
+				{
+					++Half;
+				}
+				return uint16_t(Sign | Half);
+			}
+
+			// a carry out of the mantissa correctly rolls over into the exponent
+			uint32_t Half = (uint32_t(Exponent) << 10) | (Mantissa >> 13);
+			const uint32_t Remainder = Mantissa & 0x1FFF;
+			if (Remainder > 0x1000 || (Remainder == 0x1000 && (Half & 1)))
+			{
+				++Half;
+			}
+			return uint16_t(Sign | Half);
+		}
+
+		inline float HalfToFloat(uint16_t Half)
+		{
+			const uint32_t Sign = uint32_t(Half & 0x8000) << 16;
+			const uint32_t Exponent = (Half >> 10) & 0x1F;
+			const uint32_t Mantissa = Half & 0x3FF;
+
+			uint32_t Bits;
+			if (Exponent == 0)
+			{
+				const float Denormal = float(Mantissa) * (1.0f / 16777216.0f);
+				return Sign ? -Denormal : Denormal;
+			}
+			else if (Exponent == 31)
+			{
+				Bits = Sign | 0x7F800000 | (Mantissa << 13);
+			}
+			else
+			{
+				Bits = Sign | ((Exponent + 112) << 23) | (Mantissa << 13);
+			}
+
+			float Value;
+			memcpy(&Value, &Bits, sizeof(Value));
+			return Value;
+		}
+
+		inline uint16_t FloatToSnorm16(float Value)
+		{
+			Value = Value < -1.0f ? -1.0f : (Value > 1.0f ? 1.0f : Value);
+			return uint16_t(int16_t(std::lround(Value * 32767.0f)));
+		}
+
+		inline float Snorm16ToFloat(uint16_t Value)
+		{
+			const float Result = float(int16_t(Value)) * (1.0f / 32767.0f);
+			return Result < -1.0f ? -1.0f : Result;
+		}
+
+		inline void EncodeOctahedral(float X, float Y, float Z, uint16_t& OutU, uint16_t& OutV)
+		{
+			const float Length = std::fabs(X) + std::fabs(Y) + std::fabs(Z);
+			if (Length > 0.0f)
+			{
+				X /= Length;
+				Y /= Length;
+				Z /= Length;
+			}
+			else
+			{
+				X = Y = Z = 0.0f;
+			}
+
+			// fold the lower hemisphere over the diagonals
+			if (Z < 0.0f)
+			{
+				const float FoldedX = (1.0f - std::fabs(Y)) * (X >= 0.0f ? 1.0f : -1.0f);
+				const float FoldedY = (1.0f - std::fabs(X)) * (Y >= 0.0f ? 1.0f : -1.0f);
+				X = FoldedX;
+				Y = FoldedY;
+			}
+
+			OutU = FloatToSnorm16(X);
+			OutV = FloatToSnorm16(Y);
+		}
+
+		inline void DecodeOctahedral(uint16_t U, uint16_t V, float* OutNormal)
+		{
+			float X = Snorm16ToFloat(U);
+			float Y = Snorm16ToFloat(V);
+			const float Z = 1.0f - std::fabs(X) - std::fabs(Y);
+			const float Fold = Z < 0.0f ? -Z : 0.0f;
+			X += X >= 0.0f ? -Fold : Fold;
+			Y += Y >= 0.0f ? -Fold : Fold;
+
+			const float InvLength = 1.0f / std::sqrt(X * X + Y * Y + Z * Z);
+			OutNormal[0] = X * InvLength;
+			OutNormal[1] = Y * InvLength;
+			OutNormal[2] = Z * InvLength;
+		}
+
+		inline void Write32(std::vector<uint8_t>& Out, uint32_t Value)
+		{
+			Out.push_back(uint8_t(Value));
+			Out.push_back(uint8_t(Value >> 8));
+			Out.push_back(uint8_t(Value >> 16));
+			Out.push_back(uint8_t(Value >> 24));
+		}
+
+		inline void WriteFloat(std::vector<uint8_t>& Out, float Value)
+		{
+			uint32_t Bits;
+			memcpy(&Bits, &Value, sizeof(Bits));
+			Write32(Out, Bits);
+		}
+
+		inline void WriteStream(std::vector<uint8_t>& Out, const std::vector<uint8_t>& Raw)
+		{
+			const std::vector<uint8_t> Packed = LzCompress(Raw.data(), Raw.size());
+			const std::vector<uint8_t>& Payload = Packed.size() < Raw.size() ? Packed : Raw;
+			Write32(Out, uint32_t(Raw.size()));
+			Write32(Out, uint32_t(Payload.size()));
+			Out.insert(Out.end(), Payload.begin(), Payload.end());
+		}
+
+		struct FReader
+		{
+			const uint8_t* Data;
+			size_t Size;
+			size_t Pos = 0;
+
+			bool Read32(uint32_t& OutValue)
+			{
+				if (Size - Pos < 4)
+				{
+					return false;
+				}
+				OutValue = uint32_t(Data[Pos]) | (uint32_t(Data[Pos + 1]) << 8) | (uint32_t(Data[Pos + 2]) << 16) | (uint32_t(Data[Pos + 3]) << 24);
+				Pos += 4;
+				return true;
+			}
+
+			bool ReadFloat(float& OutValue)
+			{
+				uint32_t Bits;
+				if (!Read32(Bits))
+				{
+					return false;
+				}
+				memcpy(&OutValue, &Bits, sizeof(OutValue));
+				return true;
+			}
+
+			bool ReadStream(std::vector<uint8_t>& OutRaw)
+			{
+				uint32_t RawSize, PackedSize;
+				if (!Read32(RawSize) || !Read32(PackedSize) || Size - Pos < PackedSize)
+				{
+					return false;
+				}
+				// a block can expand at most ~255x, reject sizes a corrupt header made up
+				if (uint64_t(RawSize) > uint64_t(PackedSize) * 255 + 16)
+				{
+					return false;
+				}
+
+				OutRaw.resize(RawSize);
+				const uint8_t* Payload = Data + Pos;
+				Pos += PackedSize;
+				if (PackedSize == RawSize)
+				{
+					if (RawSize > 0)
+					{
+						memcpy(OutRaw.data(), Payload, RawSize);
+					}
+					return true;
+				}
+				return LzDecompress(Payload, PackedSize, OutRaw.data(), RawSize);
+			}
+		};
+	}
+
+	/** Encodes one mesh into a self contained buffer. Safe to call from several threads at once. */
+	inline std::vector<uint8_t> EncodeMesh(const FMeshView& Mesh)
+	{
+		using namespace Detail;
+
+		const size_t VertexCount = Mesh.VertexCount;
+
+		float BoundsMin[3] = { 0.0f, 0.0f, 0.0f };
+		float BoundsMax[3] = { 0.0f, 0.0f, 0.0f };
+		for (size_t i = 0; i < VertexCount; ++i)
+		{
+			for (size_t Axis = 0; Axis < 3; ++Axis)
+			{
+				const float Value = Mesh.Positions[i * 3 + Axis];
+				if (i == 0 || Value < BoundsMin[Axis])
+				{
+					BoundsMin[Axis] = Value;
+				}
+				if (i == 0 || Value > BoundsMax[Axis])
+				{
+					BoundsMax[Axis] = Value;
+				}
+			}
+		}
+
+		std::vector<uint8_t> IndexBytes;
+		IndexBytes.reserve(Mesh.IndexCount * 2);
+		uint32_t PreviousIndex = 0;
+		for (size_t i = 0; i < Mesh.IndexCount; ++i)
+		{
+			uint32_t Coded = ZigZag32(Mesh.Indices[i] - PreviousIndex);
+			PreviousIndex = Mesh.Indices[i];
+			while (Coded >= 0x80)
+			{
+				IndexBytes.push_back(uint8_t(Coded | 0x80));
+				Coded >>= 7;
+			}
+			IndexBytes.push_back(uint8_t(Coded));
+		}
+
+		float GridOrigin[3], GridStep[3];
+		int32_t GridOffset[3];
+		std::vector<uint16_t> Positions(VertexCount * 3);
+		for (size_t Axis = 0; Axis < 3; ++Axis)
+		{
+			if (Mesh.GridOrigin && Mesh.GridStep)
+			{
+				GridOrigin[Axis] = Mesh.GridOrigin[Axis];
+				GridStep[Axis] = Mesh.GridStep[Axis];
+			}
+			else
+			{
+				GridOrigin[Axis] = BoundsMin[Axis];
+				GridStep[Axis] = (BoundsMax[Axis] - BoundsMin[Axis]) * (1.0f / 65535.0f);
+			}
+
+			// cells are counted from the shared origin so equal positions land on equal cells
+			const float Scale = GridStep[Axis] > 0.0f ? 1.0f / GridStep[Axis] : 0.0f;
+			GridOffset[Axis] = int32_t(std::floor((BoundsMin[Axis] - GridOrigin[Axis]) * Scale));
+			for (size_t i = 0; i < VertexCount; ++i)
+			{
+				const int64_t Cell = std::llround((Mesh.Positions[i * 3 + Axis] - GridOrigin[Axis]) * Scale) - GridOffset[Axis];
+				Positions[i * 3 + Axis] = uint16_t(Cell < 0 ? 0 : (Cell > 65535 ? 65535 : Cell));
+			}
+		}
+
+		// half floats lose whole units past 2048, keep uvs near zero
+		float UVOffset[2] = { 0.0f, 0.0f };
+		for (size_t i = 0; i < VertexCount; ++i)
+		{
+			for (size_t Channel = 0; Channel < 2; ++Channel)
+			{
+				const float Value = std::floor(Mesh.UVs[i * 2 + Channel]);
+				if (i == 0 || Value < UVOffset[Channel])
+				{
+					UVOffset[Channel] = Value;
+				}
+			}
+		}
+
+		std::vector<uint16_t> Normals(VertexCount * 2);
+		std::vector<uint16_t> UVs(VertexCount * 2);
+		for (size_t i = 0; i < VertexCount; ++i)
+		{
+			const float* Normal = Mesh.Normals + i * 3;
+			EncodeOctahedral(Normal[0], Normal[1], Normal[2], Normals[i * 2], Normals[i * 2 + 1]);
+			UVs[i * 2] = FloatToHalf(Mesh.UVs[i * 2] - UVOffset[0]);
+			UVs[i * 2 + 1] = FloatToHalf(Mesh.UVs[i * 2 + 1] - UVOffset[1]);
+		}
+
+		std::vector<uint8_t> Out;
+		Out.reserve(64 + Mesh.NameLength + IndexBytes.size() + VertexCount * 14);
+		Write32(Out, Magic);
+		Write32(Out, Version);
+		Write32(Out, uint32_t(VertexCount));
+		Write32(Out, uint32_t(Mesh.IndexCount));
+		for (float Value : GridOrigin)
+		{
+			WriteFloat(Out, Value);
+		}
+		for (float Value : GridStep)
+		{
+			WriteFloat(Out, Value);
+		}
+		for (int32_t Value : GridOffset)
+		{
+			Write32(Out, uint32_t(Value));
+		}
+		for (float Value : UVOffset)
+		{
+			WriteFloat(Out, Value);
+		}
+		Write32(Out, uint32_t(Mesh.NameLength));
+		Out.insert(Out.end(), Mesh.Name, Mesh.Name + Mesh.NameLength);
+
+		WriteStream(Out, IndexBytes);
+		WriteStream(Out, PackChannels(Positions, 3));
+		WriteStream(Out, PackChannels(Normals, 2));
+		WriteStream(Out, PackChannels(UVs, 2));
+		return Out;
+	}
+
+	/** Decodes a buffer written by EncodeMesh. Returns false on truncated or corrupt input. */
+	inline bool DecodeMesh(const uint8_t* Data, size_t Size, FDecodedMesh& OutMesh)
+	{
+		using namespace Detail;
+
+		FReader Reader{ Data, Size };
+
+		uint32_t FileMagic, FileVersion, VertexCount, IndexCount, NameLength;
+		if (!Reader.Read32(FileMagic) || FileMagic != Magic || !Reader.Read32(FileVersion) || FileVersion != Version)
+		{
+			return false;
+		}
+		if (!Reader.Read32(VertexCount) || !Reader.Read32(IndexCount))
+		{
+			return false;
+		}
+		for (float& Value : OutMesh.GridOrigin)
+		{
+			if (!Reader.ReadFloat(Value))
+			{
+				return false;
+			}
+		}
+		for (float& Value : OutMesh.GridStep)
+		{
+			if (!Reader.ReadFloat(Value))
+			{
+				return false;
+			}
+		}
+		for (int32_t& Value : OutMesh.GridOffset)
+		{
+			uint32_t Bits;
+			if (!Reader.Read32(Bits))
+			{
+				return false;
+			}
+			Value = int32_t(Bits);
+		}
+		for (float& Value : OutMesh.UVOffset)
+		{
+			if (!Reader.ReadFloat(Value))
+			{
+				return false;
+			}
+		}
+		if (!Reader.Read32(NameLength) || Reader.Size - Reader.Pos < NameLength)
+		{
+			return false;
+		}
+		OutMesh.Name.assign(reinterpret_cast<const char*>(Data + Reader.Pos), NameLength);
+		Reader.Pos += NameLength;
+
+		std::vector<uint8_t> IndexBytes, PositionBytes, NormalBytes, UVBytes;
+		if (!Reader.ReadStream(IndexBytes) || !Reader.ReadStream(PositionBytes) || !Reader.ReadStream(NormalBytes) || !Reader.ReadStream(UVBytes))
+		{
+			return false;
+		}
+		// every index takes at least one varint byte
+		if (IndexBytes.size() < IndexCount)
+		{
+			return false;
+		}
+		if (PositionBytes.size() != size_t(VertexCount) * 6 || NormalBytes.size() != size_t(VertexCount) * 4 || UVBytes.size() != size_t(VertexCount) * 4)
+		{
+			return false;
+		}
+
+		OutMesh.Indices.resize(IndexCount);
+		const uint8_t* Ip = IndexBytes.data();
+		const uint8_t* const IEnd = Ip + IndexBytes.size();
+		uint32_t PreviousIndex = 0;
+		for (uint32_t i = 0; i < IndexCount; ++i)
+		{
+			uint32_t Coded = 0;
+			for (uint32_t Shift = 0;; Shift += 7)
+			{
+				if (Ip == IEnd || Shift > 28)
+				{
+					return false;
+				}
+				const uint8_t Byte = *Ip++;
+				Coded |= uint32_t(Byte & 0x7F) << Shift;
+				if (!(Byte & 0x80))
+				{
+					break;
+				}
+			}
+			PreviousIndex += UnZigZag32(Coded);
+			if (PreviousIndex >= VertexCount)
+			{
+				return false;
+			}
+			OutMesh.Indices[i] = PreviousIndex;
+		}
+
+		std::vector<uint16_t> Values;
+
+		UnpackChannels(PositionBytes, 3, Values);
+		OutMesh.Positions.resize(size_t(VertexCount) * 3);
+		for (size_t Axis = 0; Axis < 3; ++Axis)
+		{
+			const float Origin = OutMesh.GridOrigin[Axis];
+			const float Step = OutMesh.GridStep[Axis];
+			const int64_t Offset = OutMesh.GridOffset[Axis];
+			for (size_t i = 0; i < VertexCount; ++i)
+			{
+				OutMesh.Positions[i * 3 + Axis] = Origin + float(Offset + Values[i * 3 + Axis]) * Step;
+			}
+		}
+
+		UnpackChannels(NormalBytes, 2, Values);
+		OutMesh.Normals.resize(size_t(VertexCount) * 3);
+		for (size_t i = 0; i < VertexCount; ++i)
+		{
+			DecodeOctahedral(Values[i * 2], Values[i * 2 + 1], OutMesh.Normals.data() + i * 3);
+		}
+
+		UnpackChannels(UVBytes, 2, Values);
+		OutMesh.UVs.resize(size_t(VertexCount) * 2);
+		for (size_t i = 0; i < VertexCount; ++i)
+		{
+			OutMesh.UVs[i * 2] = HalfToFloat(Values[i * 2]) + OutMesh.UVOffset[0];
+			OutMesh.UVs[i * 2 + 1] = HalfToFloat(Values[i * 2 + 1]) + OutMesh.UVOffset[1];
+		}
+
+		return true;
+	}
+}
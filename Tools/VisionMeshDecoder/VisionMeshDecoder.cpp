@@ -0,0 +1,383 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Standalone decoder for .vmesh files written by the VisionExporter plugin.
+// Only needs the codec header, build with e.g.
+//   c++ -O2 -std=c++17 -pthread -I../../Source/VisionExporter/Public VisionMeshDecoder.cpp -o VisionMeshDecoder
+//
+// Usage:
+//   VisionMeshDecoder <mesh.vmesh> [out.obj]   decode, optionally write the mesh back out as OBJ
+//   VisionMeshDecoder --bench [mesh.vmesh...]  report compression ratio and decode speed,
+//                                              on synthetic meshes when no file is given
+
+#include "VisionMeshCodec.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+namespace
+{
+	using FClock = std::chrono::steady_clock;
+
+	struct FSourceMesh
+	{
+		std::string Name;
+		std::vector<float> Positions;
+		std::vector<float> Normals;
+		std::vector<float> UVs;
+		std::vector<uint32_t> Indices;
+	};
+
+	bool ReadFile(const char* Path, std::vector<uint8_t>& OutData)
+	{
+		std::ifstream File(Path, std::ios::binary);
+		if (!File)
+		{
+			return false;
+		}
+		OutData.assign(std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>());
+		return true;
+	}
+
+	bool WriteObj(const VisionMeshCodec::FDecodedMesh& Mesh, const char* Path)
+	{
+		FILE* File = fopen(Path, "w");
+		if (!File)
+		{
+			return false;
+		}
+
+		const size_t VertexCount = Mesh.Positions.size() / 3;
+		fprintf(File, "g %s\n\n", Mesh.Name.c_str());
+		for (size_t i = 0; i < VertexCount; ++i)
+		{
+			fprintf(File, "v %.4f %.4f %.4f\n", Mesh.Positions[i * 3], Mesh.Positions[i * 3 + 1], Mesh.Positions[i * 3 + 2]);
+		}
+		fprintf(File, "\n");
+		for (size_t i = 0; i < VertexCount; ++i)
+		{
+			fprintf(File, "vt %.4f %.4f\n", Mesh.UVs[i * 2], Mesh.UVs[i * 2 + 1]);
+		}
+		fprintf(File, "\n");
+		for (size_t i = 0; i < VertexCount; ++i)
+		{
+			fprintf(File, "vn %.3f %.3f %.3f\n", Mesh.Normals[i * 3], Mesh.Normals[i * 3 + 1], Mesh.Normals[i * 3 + 2]);
+		}
+		fprintf(File, "\n");
+		for (size_t i = 0; i + 2 < Mesh.Indices.size(); i += 3)
+		{
+			fprintf(File, "f ");
+			for (size_t v = 0; v < 3; ++v)
+			{
+				// +1 as Wavefront files are 1 index based
+				const uint32_t Index = Mesh.Indices[i + v] + 1;
+				fprintf(File, "%u/%u/%u ", Index, Index, Index);
+			}
+			fprintf(File, "\n");
+		}
+		fprintf(File, "\n");
+
+		return fclose(File) == 0;
+	}
+
+	// Height field laid out like an exported landscape component. Base is the section base the
+	// uvs start from, Column shifts the component along x within its landscape.
+	FSourceMesh MakeGrid(const char* Name, uint32_t Quads, uint32_t Base = 0, uint32_t Column = 0)
+	{
+		FSourceMesh Mesh;
+		Mesh.Name = Name;
+		const uint32_t Side = Quads + 1;
+		for (uint32_t y = 0; y < Side; ++y)
+		{
+			for (uint32_t Local = 0; Local < Side; ++Local)
+			{
+				const uint32_t x = Column + Local;
+				const float Height = 300.0f * std::sin(x * 0.05f) * std::cos(y * 0.07f);
+				const float Nx = -15.0f * std::cos(x * 0.05f) * std::cos(y * 0.07f);
+				const float Ny = 21.0f * std::sin(x * 0.05f) * std::sin(y * 0.07f);
+				const float Length = std::sqrt(Nx * Nx + Ny * Ny + 1.0f);
+				Mesh.Positions.insert(Mesh.Positions.end(), { x * 100.0f, Height, y * 100.0f });
+				Mesh.Normals.insert(Mesh.Normals.end(), { Nx / Length, 1.0f / Length, Ny / Length });
+				Mesh.UVs.insert(Mesh.UVs.end(), { float(Base + x), 1.0f - float(Base + y) });
+			}
+		}
+		for (uint32_t y = 0; y < Quads; ++y)
+		{
+			for (uint32_t x = 0; x < Quads; ++x)
+			{
+				const uint32_t I = x + y * Side;
+				Mesh.Indices.insert(Mesh.Indices.end(), { I, I + Side + 1, I + 1, I, I + Side, I + Side + 1 });
+			}
+		}
+		return Mesh;
+	}
+
+	// Unit sphere scaled to prop size, closer to an exported static mesh.
+	FSourceMesh MakeSphere(const char* Name, uint32_t Rings, uint32_t Segments)
+	{
+		const float Pi = 3.14159265358979f;
+		FSourceMesh Mesh;
+		Mesh.Name = Name;
+		for (uint32_t r = 0; r <= Rings; ++r)
+		{
+			const float Theta = Pi * r / Rings;
+			for (uint32_t s = 0; s <= Segments; ++s)
+			{
+				const float Phi = 2.0f * Pi * s / Segments;
+				const float Nx = std::sin(Theta) * std::cos(Phi);
+				const float Ny = std::cos(Theta);
+				const float Nz = std::sin(Theta) * std::sin(Phi);
+				Mesh.Positions.insert(Mesh.Positions.end(), { Nx * 250.0f, Ny * 250.0f, Nz * 250.0f });
+				Mesh.Normals.insert(Mesh.Normals.end(), { Nx, Ny, Nz });
+				Mesh.UVs.insert(Mesh.UVs.end(), { float(s) / Segments, 1.0f - float(r) / Rings });
+			}
+		}
+		for (uint32_t r = 0; r < Rings; ++r)
+		{
+			for (uint32_t s = 0; s < Segments; ++s)
+			{
+				const uint32_t I = r * (Segments + 1) + s;
+				const uint32_t J = I + Segments + 1;
+				Mesh.Indices.insert(Mesh.Indices.end(), { I, J, I + 1, I + 1, J, J + 1 });
+			}
+		}
+		return Mesh;
+	}
+
+	size_t RawSize(const VisionMeshCodec::FDecodedMesh& Mesh)
+	{
+		return (Mesh.Positions.size() + Mesh.Normals.size() + Mesh.UVs.size()) * sizeof(float) + Mesh.Indices.size() * sizeof(uint32_t);
+	}
+
+	double Seconds(FClock::duration Duration)
+	{
+		return std::chrono::duration<double>(Duration).count();
+	}
+
+	// Decodes repeatedly for about half a second and prints throughput in terms of decoded bytes.
+	bool BenchDecode(const std::string& Label, const std::vector<uint8_t>& Encoded)
+	{
+		VisionMeshCodec::FDecodedMesh Mesh;
+		if (!VisionMeshCodec::DecodeMesh(Encoded.data(), Encoded.size(), Mesh))
+		{
+			fprintf(stderr, "%s: failed to decode\n", Label.c_str());
+			return false;
+		}
+
+		size_t Iterations = 0;
+		double Best = 1e30;
+		const FClock::time_point Start = FClock::now();
+		do
+		{
+			const FClock::time_point Begin = FClock::now();
+			VisionMeshCodec::DecodeMesh(Encoded.data(), Encoded.size(), Mesh);
+			Best = std::min(Best, Seconds(FClock::now() - Begin));
+			++Iterations;
+		} while (Seconds(FClock::now() - Start) < 0.5 || Iterations < 5);
+
+		const size_t Raw = RawSize(Mesh);
+		printf("%-24s %9zu verts %9zu tris %11zu -> %10zu bytes  ratio %5.2fx  decode %6.2f GB/s\n",
+			Label.c_str(), Mesh.Positions.size() / 3, Mesh.Indices.size() / 3, Raw, Encoded.size(),
+			double(Raw) / double(Encoded.size()), double(Raw) / Best * 1e-9);
+		return true;
+	}
+
+	std::vector<uint8_t> Encode(const FSourceMesh& Source, const float* GridOrigin = nullptr, const float* GridStep = nullptr)
+	{
+		VisionMeshCodec::FMeshView View;
+		View.Name = Source.Name.data();
+		View.NameLength = Source.Name.size();
+		View.Positions = Source.Positions.data();
+		View.Normals = Source.Normals.data();
+		View.UVs = Source.UVs.data();
+		View.VertexCount = Source.Positions.size() / 3;
+		View.Indices = Source.Indices.data();
+		View.IndexCount = Source.Indices.size();
+		View.GridOrigin = GridOrigin;
+		View.GridStep = GridStep;
+		return VisionMeshCodec::EncodeMesh(View);
+	}
+
+	// Counts border vertices of two neighbouring components that decode to different positions.
+	size_t CountSeamMismatches(const FSourceMesh& Left, const FSourceMesh& Right, uint32_t Quads, const float* GridOrigin, const float* GridStep)
+	{
+		VisionMeshCodec::FDecodedMesh A, B;
+		const std::vector<uint8_t> EncodedA = Encode(Left, GridOrigin, GridStep);
+		const std::vector<uint8_t> EncodedB = Encode(Right, GridOrigin, GridStep);
+		VisionMeshCodec::DecodeMesh(EncodedA.data(), EncodedA.size(), A);
+		VisionMeshCodec::DecodeMesh(EncodedB.data(), EncodedB.size(), B);
+
+		size_t Mismatches = 0;
+		const uint32_t Side = Quads + 1;
+		for (uint32_t y = 0; y < Side; ++y)
+		{
+			const float* PositionA = &A.Positions[(Quads + y * Side) * 3];
+			const float* PositionB = &B.Positions[(y * Side) * 3];
+			Mismatches += !std::equal(PositionA, PositionA + 3, PositionB);
+		}
+		return Mismatches;
+	}
+
+	int BenchSeam()
+	{
+		const uint32_t Quads = 63;
+		const FSourceMesh Left = MakeGrid("seam_left", Quads, 0, 0);
+		const FSourceMesh Right = MakeGrid("seam_right", Quads, Quads, Quads);
+
+		// the exporter's choice: landscape minimum as origin, largest component extent as range
+		float GridOrigin[3], GridStep[3];
+		for (size_t Axis = 0; Axis < 3; ++Axis)
+		{
+			float Min = Left.Positions[Axis], Max = Left.Positions[Axis], Extent = 0.0f;
+			for (const FSourceMesh* Component : { &Left, &Right })
+			{
+				float ComponentMin = Component->Positions[Axis], ComponentMax = ComponentMin;
+				for (size_t v = Axis; v < Component->Positions.size(); v += 3)
+				{
+					ComponentMin = std::min(ComponentMin, Component->Positions[v]);
+					ComponentMax = std::max(ComponentMax, Component->Positions[v]);
+				}
+				Min = std::min(Min, ComponentMin);
+				Max = std::max(Max, ComponentMax);
+				Extent = std::max(Extent, ComponentMax - ComponentMin);
+			}
+			GridOrigin[Axis] = Min;
+			GridStep[Axis] = Extent / 65534.0f;
+		}
+
+		const size_t OwnBounds = CountSeamMismatches(Left, Right, Quads, nullptr, nullptr);
+		const size_t Shared = CountSeamMismatches(Left, Right, Quads, GridOrigin, GridStep);
+		printf("\n%-24s %9u border verts  mismatched: own bounds %zu, shared grid %zu\n", "landscape seam", Quads + 1, OwnBounds, Shared);
+		return Shared == 0 ? 0 : 1;
+	}
+
+	int BenchSynthetic()
+	{
+		std::vector<FSourceMesh> Sources;
+		Sources.push_back(MakeGrid("grid_63", 63));
+		Sources.push_back(MakeGrid("grid_255", 255));
+		Sources.push_back(MakeGrid("grid_1023", 1023));
+		Sources.push_back(MakeGrid("grid_63_at_70000", 63, 70000));
+		Sources.push_back(MakeSphere("sphere_64x128", 64, 128));
+		Sources.push_back(MakeSphere("sphere_512x1024", 512, 1024));
+
+		// encode in parallel the same way the exporter does
+		std::vector<std::vector<uint8_t>> Encoded(Sources.size());
+		std::vector<std::thread> Workers;
+		const FClock::time_point EncodeStart = FClock::now();
+		for (size_t i = 0; i < Sources.size(); ++i)
+		{
+			Workers.emplace_back([&Sources, &Encoded, i]()
+			{
+				Encoded[i] = Encode(Sources[i]);
+			});
+		}
+		for (std::thread& Worker : Workers)
+		{
+			Worker.join();
+		}
+		printf("encoded %zu meshes in parallel in %.1f ms\n\n", Sources.size(), Seconds(FClock::now() - EncodeStart) * 1e3);
+
+		for (size_t i = 0; i < Sources.size(); ++i)
+		{
+			if (!BenchDecode(Sources[i].Name, Encoded[i]))
+			{
+				return 1;
+			}
+		}
+
+		printf("\n%-24s %14s %14s %14s\n", "round trip error", "position", "normal (deg)", "uv");
+		for (size_t i = 0; i < Sources.size(); ++i)
+		{
+			const FSourceMesh& Source = Sources[i];
+			VisionMeshCodec::FDecodedMesh Mesh;
+			VisionMeshCodec::DecodeMesh(Encoded[i].data(), Encoded[i].size(), Mesh);
+
+			float PositionError = 0.0f, NormalError = 0.0f, UVError = 0.0f;
+			for (size_t v = 0; v < Source.Positions.size(); ++v)
+			{
+				PositionError = std::max(PositionError, std::fabs(Source.Positions[v] - Mesh.Positions[v]));
+			}
+			for (size_t v = 0; v < Source.Normals.size(); v += 3)
+			{
+				float Dot = 0.0f;
+				for (size_t Axis = 0; Axis < 3; ++Axis)
+				{
+					Dot += Source.Normals[v + Axis] * Mesh.Normals[v + Axis];
+				}
+				NormalError = std::max(NormalError, std::acos(std::min(Dot, 1.0f)) * 57.2957795f);
+			}
+			for (size_t v = 0; v < Source.UVs.size(); ++v)
+			{
+				UVError = std::max(UVError, std::fabs(Source.UVs[v] - Mesh.UVs[v]));
+			}
+			if (Mesh.Indices != Source.Indices)
+			{
+				fprintf(stderr, "%s: index mismatch\n", Source.Name.c_str());
+				return 1;
+			}
+			printf("%-24s %14.4f %14.4f %14.6f\n", Source.Name.c_str(), PositionError, NormalError, UVError);
+		}
+		return BenchSeam();
+	}
+
+	int BenchFiles(int Count, char** Paths)
+	{
+		for (int i = 0; i < Count; ++i)
+		{
+			std::vector<uint8_t> Data;
+			if (!ReadFile(Paths[i], Data))
+			{
+				fprintf(stderr, "%s: cannot read file\n", Paths[i]);
+				return 1;
+			}
+			if (!BenchDecode(Paths[i], Data))
+			{
+				return 1;
+			}
+		}
+		return 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc >= 2 && std::string(argv[1]) == "--bench")
+	{
+		return argc == 2 ? BenchSynthetic() : BenchFiles(argc - 2, argv + 2);
+	}
+
+	if (argc < 2 || argc > 3)
+	{
+		fprintf(stderr, "usage: %s <mesh.vmesh> [out.obj]\n       %s --bench [mesh.vmesh...]\n", argv[0], argv[0]);
+		return 2;
+	}
+
+	std::vector<uint8_t> Data;
+	if (!ReadFile(argv[1], Data))
+	{
+		fprintf(stderr, "%s: cannot read file\n", argv[1]);
+		return 1;
+	}
+
+	VisionMeshCodec::FDecodedMesh Mesh;
+	if (!VisionMeshCodec::DecodeMesh(Data.data(), Data.size(), Mesh))
+	{
+		fprintf(stderr, "%s: not a valid vmesh file\n", argv[1]);
+		return 1;
+	}
+
+	printf("%s: %zu vertices, %zu triangles, grid step (%g %g %g)\n",
+		Mesh.Name.c_str(), Mesh.Positions.size() / 3, Mesh.Indices.size() / 3,
+		Mesh.GridStep[0], Mesh.GridStep[1], Mesh.GridStep[2]);
+
+	if (argc == 3 && !WriteObj(Mesh, argv[2]))
+	{
+		fprintf(stderr, "%s: cannot write file\n", argv[2]);
+		return 1;
+	}
+	return 0;
+}